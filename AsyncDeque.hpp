@@ -0,0 +1,173 @@
+#pragma once
+
+#include <algorithm>
+#include <coroutine>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "Deque.hpp"
+
+// Single-threaded executor: post() queues a coroutine, run() resumes queued
+// coroutines in FIFO order until none are left.
+class EventLoop {
+ public:
+  void post(std::coroutine_handle<> handle) { ready_.push_back(handle); }
+  void run() {
+    while (!ready_.empty()) {
+      std::coroutine_handle<> handle = *ready_.begin();
+      ready_.pop_front();
+      handle.resume();
+    }
+  }
+  bool empty() const noexcept { return ready_.empty(); }
+
+ private:
+  Deque<std::coroutine_handle<>> ready_;
+};
+
+// Awaitable channel on top of Deque. Suspended consumers receive values
+// directly from push_back() and suspended producers are admitted as pops free
+// capacity; woken coroutines are resumed through Executor::post(). All
+// operations must run on the executor's thread. The waiter queues hold raw
+// pointers to suspended awaiters, so the channel must outlive every coroutine
+// suspended on it.
+template <typename T, typename Executor = EventLoop>
+class AsyncDeque {
+ private:
+  struct PopWaiter {
+    std::coroutine_handle<> handle;
+    std::optional<T> value;
+  };
+
+ public:
+  class PopAwaiter;
+  class BatchPopAwaiter;
+  class PushAwaiter;
+
+  AsyncDeque(Executor& executor,
+             size_t capacity = std::numeric_limits<size_t>::max())
+      : executor_(executor), capacity_(std::max<size_t>(capacity, 1)) {}
+
+  size_t size() const noexcept { return items_.size(); }
+  bool empty() const noexcept { return items_.empty(); }
+  size_t capacity() const noexcept { return capacity_; }
+  PopAwaiter pop_front() { return PopAwaiter(this); }
+  // Resumes with between 1 and count elements: whatever is queued, up to
+  // count, once at least one is available. count == 0 resumes immediately
+  // with an empty vector.
+  BatchPopAwaiter pop_front_n(size_t count) {
+    return BatchPopAwaiter(this, count);
+  }
+  PushAwaiter push_back(T value) { return PushAwaiter(this, std::move(value)); }
+
+  class [[nodiscard]] PopAwaiter : private PopWaiter {
+   public:
+    PopAwaiter(AsyncDeque* deque) : deque_(deque) {}
+    bool await_ready() const noexcept { return !deque_->items_.empty(); }
+    void await_suspend(std::coroutine_handle<> handle) {
+      this->handle = handle;
+      deque_->pop_waiters_.push_back(this);
+    }
+    T await_resume() {
+      if (this->value) {
+        return std::move(*this->value);
+      }
+      T value = std::move(*deque_->items_.begin());
+      deque_->items_.pop_front();
+      deque_->admit_pushers();
+      return value;
+    }
+
+   private:
+    AsyncDeque* deque_;
+  };
+
+  class [[nodiscard]] BatchPopAwaiter : private PopWaiter {
+   public:
+    BatchPopAwaiter(AsyncDeque* deque, size_t count)
+        : deque_(deque), count_(count) {}
+    bool await_ready() const noexcept {
+      return count_ == 0 || !deque_->items_.empty();
+    }
+    void await_suspend(std::coroutine_handle<> handle) {
+      this->handle = handle;
+      deque_->pop_waiters_.push_back(this);
+    }
+    std::vector<T> await_resume() {
+      std::vector<T> batch;
+      if (this->value) {
+        batch.push_back(std::move(*this->value));
+      }
+      size_t count =
+          std::min(count_ - batch.size(), deque_->items_.size());
+      batch.reserve(batch.size() + count);
+      auto iter = deque_->items_.begin();
+      for (size_t i = 0; i < count; ++i, ++iter) {
+        batch.push_back(std::move(*iter));
+      }
+      deque_->items_.pop_front_n(count);
+      deque_->admit_pushers();
+      return batch;
+    }
+
+   private:
+    AsyncDeque* deque_;
+    size_t count_;
+  };
+
+  class [[nodiscard]] PushAwaiter {
+   public:
+    PushAwaiter(AsyncDeque* deque, T&& value)
+        : deque_(deque), value_(std::move(value)) {}
+    bool await_ready() { return deque_->try_push_back(value_); }
+    void await_suspend(std::coroutine_handle<> handle) {
+      handle_ = handle;
+      deque_->push_waiters_.push_back(this);
+    }
+    void await_resume() const noexcept {}
+
+   private:
+    friend class AsyncDeque;
+    AsyncDeque* deque_;
+    T value_;
+    std::coroutine_handle<> handle_;
+  };
+
+ private:
+  bool try_push_back(T& value);
+  void admit_pushers();
+
+  Executor& executor_;
+  size_t capacity_;
+  Deque<T> items_;
+  Deque<PopWaiter*> pop_waiters_;
+  Deque<PushAwaiter*> push_waiters_;
+};
+
+template <typename T, typename Executor>
+bool AsyncDeque<T, Executor>::try_push_back(T& value) {
+  if (!pop_waiters_.empty()) {
+    PopWaiter* waiter = *pop_waiters_.begin();
+    pop_waiters_.pop_front();
+    waiter->value.emplace(std::move(value));
+    executor_.post(waiter->handle);
+    return true;
+  }
+  if (items_.size() < capacity_) {
+    items_.push_back(std::move(value));
+    return true;
+  }
+  return false;
+}
+
+template <typename T, typename Executor>
+void AsyncDeque<T, Executor>::admit_pushers() {
+  while (!push_waiters_.empty() && items_.size() < capacity_) {
+    PushAwaiter* waiter = *push_waiters_.begin();
+    push_waiters_.pop_front();
+    items_.push_back(std::move(waiter->value_));
+    executor_.post(waiter->handle_);
+  }
+}
@@ -0,0 +1,354 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "Deque.hpp"
+
+// Deque of integers whose full interior chunks are kept compressed. Values
+// are stored as a raw head and tail edge around a Deque of cold blocks; every
+// cold block holds exactly one Deque chunk worth of values, encoded as
+// bit-packed deltas relative to the smallest delta (frame of reference) with
+// an absolute anchor every kAnchorStride values. A single element is read by
+// decoding at most kAnchorStride - 1 deltas; a block touched twice in a row
+// is decompressed into a small round-robin cache, so even const access is not
+// thread-safe. Elements are read by value.
+template <typename T>
+class CompressedDeque {
+  static_assert(std::is_integral_v<T> && !std::is_same_v<T, bool>,
+                "CompressedDeque requires an integer type");
+
+ public:
+  using value_type = T;
+
+  size_t size() const noexcept {
+    return head_.size() + cold_.size() * kBlockSize + tail_.size();
+  }
+  bool empty() const noexcept { return size() == 0; }
+  T operator[](size_t index) const;
+  T at(size_t index) const;
+  void push_back(T value);
+  void push_front(T value);
+  void pop_back();
+  void pop_front();
+  void clear() noexcept;
+  template <typename Func>
+  void for_each_segment(Func func) const;
+  size_t memory_usage() const noexcept;
+  double compression_ratio() const noexcept;
+
+ private:
+  using Unsigned = std::make_unsigned_t<T>;
+  using Signed = std::make_signed_t<T>;
+  static const size_t kBlockSize = Deque<T>::chunk_capacity();
+  static const size_t kAnchorStride = 64;
+  static const size_t kCacheSize = 4;
+  static const uint64_t kNoBlock = UINT64_MAX;
+  static_assert(kBlockSize % kAnchorStride == 0);
+
+  struct Block {
+    uint64_t id;
+    Unsigned min_delta;
+    unsigned width;
+    std::array<Unsigned, kBlockSize / kAnchorStride> anchors;
+    std::vector<uint64_t> words;
+  };
+  struct CacheEntry {
+    uint64_t id = kNoBlock;
+    std::vector<T> values;
+  };
+  // Raw values at one end of the deque, kept in a buffer of kBlockSize
+  // reserved slots that is reused rather than reallocated. Live values are
+  // values[begin, values.size()); the outer end is values.back(), which is the
+  // last element of the tail and the first element of the head.
+  struct Edge {
+    std::vector<T> values;
+    size_t begin = 0;
+
+    size_t size() const noexcept { return values.size() - begin; }
+    bool empty() const noexcept { return size() == 0; }
+    T from_outer(size_t index) const {
+      return values[values.size() - 1 - index];
+    }
+    T from_inner(size_t index) const { return values[begin + index]; }
+    void push_outer(T value) {
+      if (values.capacity() < kBlockSize) {
+        values.reserve(kBlockSize);
+      }
+      if (values.size() == kBlockSize) {
+        values.erase(values.begin(), values.begin() + begin);
+        begin = 0;
+      }
+      values.push_back(value);
+    }
+    void pop_outer() {
+      values.pop_back();
+      if (empty()) {
+        reset();
+      }
+    }
+    void pop_inner() {
+      if (++begin == values.size()) {
+        reset();
+      }
+    }
+    void reset() noexcept {
+      values.clear();
+      begin = 0;
+    }
+  };
+
+  Block encode(const T* values);
+  static uint64_t offset_at(const Block& block, size_t position);
+  static void decode(const Block& block, T* out);
+  static T decode_one(const Block& block, size_t position);
+  const T* cached(const Block& block) const;
+  T cold_value(const Block& block, size_t position) const;
+
+  Edge head_;
+  Deque<Block> cold_;
+  Edge tail_;
+  uint64_t next_block_id_ = 0;
+  mutable std::array<CacheEntry, kCacheSize> cache_;
+  mutable size_t cache_next_ = 0;
+  mutable uint64_t last_miss_ = kNoBlock;
+};
+
+template <typename T>
+typename CompressedDeque<T>::Block CompressedDeque<T>::encode(
+    const T* values) {
+  Block block{next_block_id_++, 0, 0, {}, {}};
+  Signed min_delta = static_cast<Signed>(
+      static_cast<Unsigned>(values[1]) - static_cast<Unsigned>(values[0]));
+  for (size_t i = 2; i < kBlockSize; ++i) {
+    min_delta = std::min(
+        min_delta, static_cast<Signed>(static_cast<Unsigned>(values[i]) -
+                                       static_cast<Unsigned>(values[i - 1])));
+  }
+  block.min_delta = static_cast<Unsigned>(min_delta);
+  uint64_t max_offset = 0;
+  for (size_t i = 1; i < kBlockSize; ++i) {
+    Unsigned offset = static_cast<Unsigned>(values[i]) -
+                      static_cast<Unsigned>(values[i - 1]) - block.min_delta;
+    max_offset = std::max<uint64_t>(max_offset, offset);
+  }
+  while (block.width < 64 && (max_offset >> block.width) != 0) {
+    ++block.width;
+  }
+  for (size_t i = 0; i < block.anchors.size(); ++i) {
+    block.anchors[i] = static_cast<Unsigned>(values[i * kAnchorStride]);
+  }
+  block.words.assign(((kBlockSize - 1) * block.width + 63) / 64 + 1, 0);
+  for (size_t i = 1; block.width != 0 && i < kBlockSize; ++i) {
+    uint64_t offset = static_cast<Unsigned>(
+        static_cast<Unsigned>(values[i]) -
+        static_cast<Unsigned>(values[i - 1]) - block.min_delta);
+    size_t bit = (i - 1) * block.width;
+    size_t shift = bit % 64;
+    block.words[bit / 64] |= offset << shift;
+    if (shift + block.width > 64) {
+      block.words[bit / 64 + 1] |= offset >> (64 - shift);
+    }
+  }
+  return block;
+}
+
+template <typename T>
+uint64_t CompressedDeque<T>::offset_at(const Block& block, size_t position) {
+  if (block.width == 0) {
+    return 0;
+  }
+  size_t bit = (position - 1) * block.width;
+  size_t shift = bit % 64;
+  const uint64_t* word = block.words.data() + bit / 64;
+  uint64_t offset = (word[0] >> shift) | ((word[1] << 1) << (63 - shift));
+  return (block.width == 64) ? offset
+                             : offset & ((uint64_t{1} << block.width) - 1);
+}
+
+template <typename T>
+void CompressedDeque<T>::decode(const Block& block, T* out) {
+  Unsigned current = block.anchors[0];
+  out[0] = static_cast<T>(current);
+  for (size_t i = 1; i < kBlockSize; ++i) {
+    current += static_cast<Unsigned>(offset_at(block, i)) + block.min_delta;
+    out[i] = static_cast<T>(current);
+  }
+}
+
+template <typename T>
+T CompressedDeque<T>::decode_one(const Block& block, size_t position) {
+  size_t first = position / kAnchorStride * kAnchorStride;
+  uint64_t offsets = 0;
+  for (size_t i = first + 1; i <= position; ++i) {
+    offsets += offset_at(block, i);
+  }
+  return static_cast<T>(block.anchors[first / kAnchorStride] +
+                        static_cast<Unsigned>(offsets) +
+                        static_cast<Unsigned>(position - first) *
+                            block.min_delta);
+}
+
+template <typename T>
+const T* CompressedDeque<T>::cached(const Block& block) const {
+  for (const auto& entry : cache_) {
+    if (entry.id == block.id) {
+      return entry.values.data();
+    }
+  }
+  CacheEntry& victim = cache_[cache_next_];
+  cache_next_ = (cache_next_ + 1) % kCacheSize;
+  victim.values.resize(kBlockSize);
+  decode(block, victim.values.data());
+  victim.id = block.id;
+  return victim.values.data();
+}
+
+template <typename T>
+T CompressedDeque<T>::cold_value(const Block& block, size_t position) const {
+  for (const auto& entry : cache_) {
+    if (entry.id == block.id) {
+      return entry.values[position];
+    }
+  }
+  if (last_miss_ == block.id) {
+    return cached(block)[position];
+  }
+  last_miss_ = block.id;
+  return decode_one(block, position);
+}
+
+template <typename T>
+T CompressedDeque<T>::operator[](size_t index) const {
+  size_t head_size = head_.size();
+  if (index < head_size) {
+    return head_.from_outer(index);
+  }
+  index -= head_size;
+  size_t cold_size = cold_.size() * kBlockSize;
+  if (index < cold_size) {
+    return cold_value(cold_[index / kBlockSize], index % kBlockSize);
+  }
+  return tail_.from_inner(index - cold_size);
+}
+
+template <typename T>
+T CompressedDeque<T>::at(size_t index) const {
+  if (index >= size()) {
+    throw std::out_of_range("deque");
+  }
+  return (*this)[index];
+}
+
+template <typename T>
+void CompressedDeque<T>::push_back(T value) {
+  if (tail_.size() == kBlockSize) {
+    cold_.push_back(encode(tail_.values.data()));
+    tail_.reset();
+  }
+  tail_.push_outer(value);
+}
+
+template <typename T>
+void CompressedDeque<T>::push_front(T value) {
+  if (head_.size() == kBlockSize) {
+    std::reverse(head_.values.begin(), head_.values.end());
+    try {
+      cold_.push_front(encode(head_.values.data()));
+    } catch (...) {
+      std::reverse(head_.values.begin(), head_.values.end());
+      throw;
+    }
+    head_.reset();
+  }
+  head_.push_outer(value);
+}
+
+template <typename T>
+void CompressedDeque<T>::pop_back() {
+  if (tail_.empty()) {
+    if (cold_.empty()) {
+      head_.pop_inner();
+      return;
+    }
+    const T* values = cached(*(cold_.end() - 1));
+    tail_.values.reserve(kBlockSize);
+    tail_.values.assign(values, values + kBlockSize);
+    cold_.pop_back_n(1);
+  }
+  tail_.pop_outer();
+}
+
+template <typename T>
+void CompressedDeque<T>::pop_front() {
+  if (head_.empty()) {
+    if (cold_.empty()) {
+      tail_.pop_inner();
+      return;
+    }
+    const T* values = cached(*cold_.begin());
+    head_.values.reserve(kBlockSize);
+    head_.values.assign(std::reverse_iterator<const T*>(values + kBlockSize),
+                        std::reverse_iterator<const T*>(values));
+    cold_.pop_front();
+  }
+  head_.pop_outer();
+}
+
+template <typename T>
+void CompressedDeque<T>::clear() noexcept {
+  head_.reset();
+  cold_.clear();
+  tail_.reset();
+  for (auto& entry : cache_) {
+    entry.id = kNoBlock;
+  }
+  last_miss_ = kNoBlock;
+}
+
+template <typename T>
+template <typename Func>
+void CompressedDeque<T>::for_each_segment(Func func) const {
+  std::vector<T> scratch(kBlockSize);
+  if (!head_.empty()) {
+    std::reverse_copy(head_.values.begin() + head_.begin, head_.values.end(),
+                      scratch.begin());
+    func(std::span<const T>(scratch.data(), head_.size()));
+  }
+  for (const auto& block : cold_) {
+    decode(block, scratch.data());
+    func(std::span<const T>(scratch));
+  }
+  if (!tail_.empty()) {
+    func(std::span<const T>(tail_.values.data() + tail_.begin, tail_.size()));
+  }
+}
+
+// Bytes currently allocated for the contents: both edge buffers, the cold
+// block Deque (chunks and map), every block's packed words and the decode
+// cache. Per-allocation overhead of the allocator itself is not included.
+template <typename T>
+size_t CompressedDeque<T>::memory_usage() const noexcept {
+  size_t bytes = sizeof(*this) +
+                 (head_.values.capacity() + tail_.values.capacity()) *
+                     sizeof(T) +
+                 cold_.memory_usage();
+  for (const auto& block : cold_) {
+    bytes += block.words.capacity() * sizeof(uint64_t);
+  }
+  for (const auto& entry : cache_) {
+    bytes += entry.values.capacity() * sizeof(T);
+  }
+  return bytes;
+}
+
+template <typename T>
+double CompressedDeque<T>::compression_ratio() const noexcept {
+  return static_cast<double>(size() * sizeof(T)) /
+         static_cast<double>(memory_usage());
+}
@@ -1,8 +1,13 @@
+#pragma once
+
+#include <algorithm>
 #include <exception>
+#include <functional>
 #include <initializer_list>
 #include <iostream>
 #include <iterator>
 #include <memory>
+#include <span>
 #include <type_traits>
 #include <vector>
 
@@ -86,10 +91,18 @@ class Deque {
 
   bool empty() const noexcept { return size() == 0; };
   allocator_type get_allocator() { return alloc_obj_; }
+  static constexpr size_t chunk_capacity() noexcept {
+    return ChunkSize::kValue;
+  }
+  size_t memory_usage() const noexcept;
   T& operator[](size_t index);
   const T& operator[](size_t index) const;
   T& at(size_t index);
   const T& at(size_t index) const;
+  template <typename IndexRange, typename OutputIt>
+  OutputIt gather(const IndexRange& indices, OutputIt out) const;
+  template <typename IndexRange, typename OutputIt>
+  OutputIt gather_at(const IndexRange& indices, OutputIt out) const;
   void push_back(const T& value);
   void push_back(T&& value);
   template <typename... Args>
@@ -100,6 +113,28 @@ class Deque {
   template <typename... Args>
   void emplace_front(Args&&... args);
   void pop_front();
+  void pop_back_n(size_t count);
+  void pop_front_n(size_t count);
+  void clear() noexcept;
+  void resize(size_t count);
+  void resize(size_t count, const T& value);
+  std::span<T> prepare_back();
+  void commit_back(size_t count);
+  std::span<T> prepare_front();
+  void commit_front(size_t count);
+  template <typename Key, typename Projection = std::identity>
+  iterator lower_bound(const Key& key, Projection proj = {});
+  template <typename Key, typename Projection = std::identity>
+  const_iterator lower_bound(const Key& key, Projection proj = {}) const;
+  template <typename Key, typename Projection = std::identity>
+  size_t pop_front_while_less(const Key& key, Projection proj = {});
+  void erase_prefix_until(iterator iter);
+  template <typename Func>
+  void for_each_segment(Func func);
+  template <typename Func>
+  void for_each_segment(Func func) const;
+  std::span<T> back_segment();
+  std::span<const T> back_segment() const;
   template <typename... Args>
   iterator emplace(iterator iter, Args&&... args);
   iterator insert(iterator iter, const T& value);
@@ -217,13 +252,31 @@ class Deque {
         sizeof(T) < 256 ? 4096 / sizeof(T) : 16;
   };
 
+  static const difference_type kGatherDistance = 16;
+  static const bool kTrivialDestroy =
+      std::is_trivially_destructible_v<T> &&
+      std::is_same_v<value_allocator, std::allocator<T>>;
+
+  static void prefetch(const void* address) {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address);
+#endif
+  }
   static size_t chunks_amount(size_t num) {
     size_t min_size = 2;
     return std::max(min_size,
                     num / ChunkSize::kValue + (num % ChunkSize::kValue != 0));
   }
-  void clear() noexcept;
+  void release() noexcept;
+  void destroy_range(T* begin, T* end) noexcept;
+  T* const* chunk_slot(size_t index) const;
+  template <typename Key, typename Projection>
+  std::pair<size_t, T*> lower_bound_position(const Key& key,
+                                             Projection& proj) const;
+  T* element_address(size_t index) const;
   void reallocate();
+  void retire_front_chunk();
+  void retire_back_chunk();
   void base_allocation();
   void particular_clear(std::vector<T*, chunk_allocator>& new_buffer, T* begin,
                         size_t begin_index, T* end,
@@ -235,20 +288,16 @@ class Deque {
 };
 
 template <typename T, typename Allocator>
-void Deque<T, Allocator>::clear() noexcept {
+void Deque<T, Allocator>::release() noexcept {
   if (buffer_.empty()) {
     return;
   }
-  if (!empty()) {
-    size_t back_temp_index = info_.back_index;
-    while (info_.back != info_.front) {
-      value_alloc_traits::destroy(alloc_obj_, info_.back);
-      if (info_.back == buffer_[back_temp_index] + ChunkSize::kValue - 1) {
-        ++back_temp_index;
-        info_.back = buffer_[back_temp_index];
-      } else {
-        ++info_.back;
-      }
+  if (info_.back != info_.front) {
+    for (size_t i = info_.back_index; i <= info_.front_index; ++i) {
+      T* begin = (i == info_.back_index) ? info_.back : buffer_[i];
+      T* end = (i == info_.front_index) ? info_.front
+                                        : buffer_[i] + ChunkSize::kValue;
+      destroy_range(begin, end);
     }
   }
   for (size_t i = 0; i < buffer_.size(); ++i) {
@@ -259,6 +308,26 @@ void Deque<T, Allocator>::clear() noexcept {
   buffer_.clear();
 }
 
+template <typename T, typename Allocator>
+void Deque<T, Allocator>::destroy_range(T* begin, T* end) noexcept {
+  if constexpr (!kTrivialDestroy) {
+    for (; begin != end; ++begin) {
+      value_alloc_traits::destroy(alloc_obj_, begin);
+    }
+  }
+}
+
+template <typename T, typename Allocator>
+size_t Deque<T, Allocator>::memory_usage() const noexcept {
+  size_t bytes = buffer_.capacity() * sizeof(T*);
+  for (size_t i = 0; i < buffer_.size(); ++i) {
+    if (buffer_[i] != nullptr) {
+      bytes += ChunkSize::kValue * sizeof(T);
+    }
+  }
+  return bytes;
+}
+
 template <typename T, typename Allocator>
 void Deque<T, Allocator>::base_allocation() {
   for (size_t i = 0; i < buffer_.size(); ++i) {
@@ -321,7 +390,7 @@ Deque<T, Allocator>::Deque(const Deque& other)
       }
     }
     info_.back = info_.front = nullptr;
-    clear();
+    release();
     throw;
   }
 }
@@ -358,7 +427,7 @@ Deque<T, Allocator>::Deque(size_t count, const Allocator& alloc)
     info_.back = info_.front = nullptr;
     info_.back_index = 0;
     info_.front_index = buffer_.size() - 1;
-    clear();
+    release();
     throw;
   }
 }
@@ -394,7 +463,7 @@ Deque<T, Allocator>::Deque(size_t count, const T& value, const Allocator& alloc)
     info_.back = info_.front = nullptr;
     info_.back_index = 0;
     info_.front_index = buffer_.size() - 1;
-    clear();
+    release();
     throw;
   }
 }
@@ -442,14 +511,14 @@ Deque<T, Allocator>::Deque(std::initializer_list<T> init,
     info_.back = info_.front = nullptr;
     info_.back_index = 0;
     info_.front_index = buffer_.size() - 1;
-    clear();
+    release();
     throw;
   }
 }
 
 template <typename T, typename Allocator>
 Deque<T, Allocator>::~Deque() {
-  clear();
+  release();
 }
 
 template <typename T, typename Allocator>
@@ -519,7 +588,7 @@ Deque<T, Allocator>& Deque<T, Allocator>::operator=(
     new_buffer.clear();
     throw;
   }
-  clear();
+  release();
   alloc_obj_ = temp_alloc;
   chunk_alloc_ = other.chunk_alloc_;
   buffer_ = std::move(new_buffer);
@@ -535,7 +604,7 @@ Deque<T, Allocator>::operator=(Deque<T, Allocator>&& other) noexcept(
   if (this == &other) {
     return *this;
   }
-  clear();
+  release();
   if (value_alloc_traits::propagate_on_container_move_assignment::value ||
       alloc_obj_ != other.alloc_obj_) {
     alloc_obj_ = std::move(other.alloc_obj_);
@@ -585,25 +654,136 @@ const T& Deque<T, Allocator>::at(size_t index) const {
                 [shift % ChunkSize::kValue];
 }
 
+template <typename T, typename Allocator>
+T* const* Deque<T, Allocator>::chunk_slot(size_t index) const {
+  size_t shift = (info_.back - buffer_[info_.back_index]) + index;
+  return &buffer_[info_.back_index + shift / ChunkSize::kValue];
+}
+
+template <typename T, typename Allocator>
+T* Deque<T, Allocator>::element_address(size_t index) const {
+  size_t shift = (info_.back - buffer_[info_.back_index]) + index;
+  return buffer_[info_.back_index + shift / ChunkSize::kValue] +
+         shift % ChunkSize::kValue;
+}
+
+// Resolves positions in a software pipeline: the map entry for an index is
+// prefetched 2 * kGatherDistance lookups ahead, and the element is prefetched
+// kGatherDistance lookups ahead once its map entry is cached. A bare copy loop
+// already saturates the core's outstanding misses, so the gain shows up when
+// writing to out does per-element work that limits out-of-order lookahead.
+template <typename T, typename Allocator>
+template <typename IndexRange, typename OutputIt>
+OutputIt Deque<T, Allocator>::gather(const IndexRange& indices,
+                                     OutputIt out) const {
+  auto current = std::begin(indices);
+  auto last = std::end(indices);
+  auto slot_ahead = current;
+  for (difference_type i = 0; i < kGatherDistance && slot_ahead != last;
+       ++i, ++slot_ahead) {
+    prefetch(chunk_slot(*slot_ahead));
+  }
+  auto element_ahead = current;
+  for (difference_type i = 0; i < kGatherDistance && slot_ahead != last;
+       ++i, ++slot_ahead, ++element_ahead) {
+    prefetch(chunk_slot(*slot_ahead));
+    prefetch(element_address(*element_ahead));
+  }
+  for (; slot_ahead != last; ++slot_ahead, ++element_ahead, ++current) {
+    prefetch(chunk_slot(*slot_ahead));
+    prefetch(element_address(*element_ahead));
+    *out = *element_address(*current);
+    ++out;
+  }
+  for (; element_ahead != last; ++element_ahead, ++current) {
+    prefetch(element_address(*element_ahead));
+    *out = *element_address(*current);
+    ++out;
+  }
+  for (; current != last; ++current) {
+    *out = *element_address(*current);
+    ++out;
+  }
+  return out;
+}
+
+template <typename T, typename Allocator>
+template <typename IndexRange, typename OutputIt>
+OutputIt Deque<T, Allocator>::gather_at(const IndexRange& indices,
+                                        OutputIt out) const {
+  size_t current_size = size();
+  for (const auto& index : indices) {
+    if (static_cast<size_t>(index) >= current_size) {
+      throw std::out_of_range("deque");
+    }
+  }
+  return gather(indices, out);
+}
+
 template <typename T, typename Allocator>
 void Deque<T, Allocator>::reallocate() {
   if (buffer_.empty()) {
     buffer_.resize(2, nullptr);
     return;
   }
-  std::vector<T*, chunk_allocator> new_buffer(buffer_.size() * 2, nullptr,
-                                              chunk_alloc_);
-  size_t new_start = buffer_.size() / 2;
+  size_t used = info_.front_index - info_.back_index + 1;
+  size_t new_size =
+      (used * 2 + 2 <= buffer_.size()) ? buffer_.size() : buffer_.size() * 2;
+  size_t new_back = (new_size - used) / 2;
+  std::vector<T*, chunk_allocator> new_buffer(new_size, nullptr, chunk_alloc_);
   for (size_t i = 0; i < buffer_.size(); ++i) {
-    new_buffer[new_start] = buffer_[i];
+    if (buffer_[i] == nullptr) {
+      continue;
+    }
+    if (i + 1 >= info_.back_index && i <= info_.front_index + 1) {
+      new_buffer[new_back + i - info_.back_index] = buffer_[i];
+    } else {
+      value_alloc_traits::deallocate(alloc_obj_, buffer_[i], ChunkSize::kValue);
+    }
     buffer_[i] = nullptr;
-    ++new_start;
   }
-  info_.front_index += buffer_.size() / 2;
-  info_.back_index += buffer_.size() / 2;
+  info_.back_index = new_back;
+  info_.front_index = new_back + used - 1;
   buffer_ = std::move(new_buffer);
 }
 
+// Chunk policy: apart from the chunks holding elements, the deque keeps at
+// most one spare chunk right outside each end. A chunk vacated by a pop
+// becomes the spare of its end; the spare it displaces is handed to the
+// other end when that end has none and freed otherwise. Queue-style use thus
+// cycles chunks without allocating, and reallocate() recenters the map
+// instead of growing it while the contents stay small.
+template <typename T, typename Allocator>
+void Deque<T, Allocator>::retire_front_chunk() {
+  size_t spare = info_.back_index - 1;
+  if (info_.back_index > 0 && buffer_[spare] != nullptr) {
+    size_t other = info_.front_index + 1;
+    if (other < buffer_.size() && buffer_[other] == nullptr) {
+      buffer_[other] = buffer_[spare];
+    } else {
+      value_alloc_traits::deallocate(alloc_obj_, buffer_[spare],
+                                     ChunkSize::kValue);
+    }
+    buffer_[spare] = nullptr;
+  }
+  ++info_.back_index;
+}
+
+template <typename T, typename Allocator>
+void Deque<T, Allocator>::retire_back_chunk() {
+  size_t spare = info_.front_index + 1;
+  if (spare < buffer_.size() && buffer_[spare] != nullptr) {
+    if (info_.back_index > 0 && buffer_[info_.back_index - 1] == nullptr) {
+      buffer_[info_.back_index - 1] = buffer_[spare];
+    } else {
+      value_alloc_traits::deallocate(alloc_obj_, buffer_[spare],
+                                     ChunkSize::kValue);
+    }
+    buffer_[spare] = nullptr;
+  }
+  --info_.front_index;
+}
+
 template <typename T, typename Allocator>
 void Deque<T, Allocator>::push_back(const T& value) {
   emplace_back(value);
@@ -625,12 +805,7 @@ void Deque<T, Allocator>::pop_back() {
     return;
   }
   if (info_.front == buffer_[info_.front_index]) {
-    if (info_.front_index - info_.back_index > 2) {
-      value_alloc_traits::deallocate(alloc_obj_, buffer_[info_.front_index],
-                                     ChunkSize::kValue);
-      buffer_[info_.front_index] = nullptr;
-    }
-    --info_.front_index;
+    retire_back_chunk();
   }
   info_.front = deleted;
 }
@@ -698,12 +873,7 @@ template <typename T, typename Allocator>
 void Deque<T, Allocator>::pop_front() {
   value_alloc_traits::destroy(alloc_obj_, info_.back);
   if (info_.back == buffer_[info_.back_index] + ChunkSize::kValue - 1) {
-    if (info_.front_index - info_.back_index > 2) {
-      value_alloc_traits::deallocate(alloc_obj_, buffer_[info_.back_index],
-                                     ChunkSize::kValue);
-      buffer_[info_.back_index] = nullptr;
-    }
-    ++info_.back_index;
+    retire_front_chunk();
     info_.back = buffer_[info_.back_index];
   } else {
     ++info_.back;
@@ -713,6 +883,292 @@ void Deque<T, Allocator>::pop_front() {
   }
 }
 
+template <typename T, typename Allocator>
+void Deque<T, Allocator>::pop_back_n(size_t count) {
+  while (count > 0) {
+    if (info_.front == buffer_[info_.front_index]) {
+      retire_back_chunk();
+      info_.front = buffer_[info_.front_index] + ChunkSize::kValue;
+    }
+    T* chunk_begin = (info_.front_index == info_.back_index)
+                         ? info_.back
+                         : buffer_[info_.front_index];
+    size_t segment =
+        std::min(count, static_cast<size_t>(info_.front - chunk_begin));
+    destroy_range(info_.front - segment, info_.front);
+    info_.front -= segment;
+    count -= segment;
+  }
+  if (info_.back == info_.front) {
+    info_.front_index = info_.back_index;
+    info_.back = info_.front = buffer_[info_.back_index];
+  }
+}
+
+template <typename T, typename Allocator>
+void Deque<T, Allocator>::pop_front_n(size_t count) {
+  while (count > 0) {
+    T* chunk_end = buffer_[info_.back_index] + ChunkSize::kValue;
+    size_t segment =
+        std::min(count, static_cast<size_t>(chunk_end - info_.back));
+    destroy_range(info_.back, info_.back + segment);
+    info_.back += segment;
+    count -= segment;
+    if (info_.back == chunk_end) {
+      retire_front_chunk();
+      info_.back = buffer_[info_.back_index];
+    }
+  }
+  if (info_.back == info_.front) {
+    info_.back = info_.front = buffer_[info_.back_index];
+  }
+}
+
+template <typename T, typename Allocator>
+void Deque<T, Allocator>::clear() noexcept {
+  if (info_.back != info_.front) {
+    for (size_t i = info_.back_index; i <= info_.front_index; ++i) {
+      T* begin = (i == info_.back_index) ? info_.back : buffer_[i];
+      T* end = (i == info_.front_index) ? info_.front
+                                        : buffer_[i] + ChunkSize::kValue;
+      destroy_range(begin, end);
+    }
+  }
+  for (size_t i = 0; i < buffer_.size(); ++i) {
+    if (buffer_[i] != nullptr &&
+        (i + 1 < info_.back_index || i > info_.back_index + 1)) {
+      value_alloc_traits::deallocate(alloc_obj_, buffer_[i], ChunkSize::kValue);
+      buffer_[i] = nullptr;
+    }
+  }
+  info_.front_index = info_.back_index;
+  info_.back = info_.front = buffer_[info_.back_index];
+}
+
+template <typename T, typename Allocator>
+void Deque<T, Allocator>::resize(size_t count) {
+  size_t old_size = size();
+  if (count <= old_size) {
+    pop_back_n(old_size - count);
+    return;
+  }
+  try {
+    for (size_t i = old_size; i < count; ++i) {
+      emplace_back();
+    }
+  } catch (...) {
+    pop_back_n(size() - old_size);
+    throw;
+  }
+}
+
+template <typename T, typename Allocator>
+void Deque<T, Allocator>::resize(size_t count, const T& value) {
+  size_t old_size = size();
+  if (count <= old_size) {
+    pop_back_n(old_size - count);
+    return;
+  }
+  try {
+    for (size_t i = old_size; i < count; ++i) {
+      emplace_back(value);
+    }
+  } catch (...) {
+    pop_back_n(size() - old_size);
+    throw;
+  }
+}
+
+// Direct-fill ingestion for trivially copyable T: prepare_back() exposes the
+// uninitialized tail of the last chunk and commit_back() appends the first
+// count elements of it. prepare_front() exposes the free space before the
+// first element and commit_front() prepends the last count elements of it.
+template <typename T, typename Allocator>
+std::span<T> Deque<T, Allocator>::prepare_back() {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "direct fill requires a trivially copyable type");
+  return std::span<T>(info_.front, buffer_[info_.front_index] +
+                                       ChunkSize::kValue - info_.front);
+}
+
+template <typename T, typename Allocator>
+void Deque<T, Allocator>::commit_back(size_t count) {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "direct fill requires a trivially copyable type");
+  if (count == 0) {
+    return;
+  }
+  if ((info_.front += count) - buffer_[info_.front_index] ==
+      ChunkSize::kValue) {
+    if (info_.front_index == buffer_.size() - 1) {
+      reallocate();
+    }
+    if (buffer_[++info_.front_index] == nullptr) {
+      buffer_[info_.front_index] =
+          value_alloc_traits::allocate(alloc_obj_, ChunkSize::kValue);
+    }
+    info_.front = buffer_[info_.front_index];
+  }
+}
+
+template <typename T, typename Allocator>
+std::span<T> Deque<T, Allocator>::prepare_front() {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "direct fill requires a trivially copyable type");
+  if (info_.back != buffer_[info_.back_index]) {
+    return std::span<T>(buffer_[info_.back_index], info_.back);
+  }
+  if (info_.back_index == 0) {
+    reallocate();
+  }
+  if (buffer_[info_.back_index - 1] == nullptr) {
+    buffer_[info_.back_index - 1] =
+        value_alloc_traits::allocate(alloc_obj_, ChunkSize::kValue);
+  }
+  return std::span<T>(buffer_[info_.back_index - 1], ChunkSize::kValue);
+}
+
+template <typename T, typename Allocator>
+void Deque<T, Allocator>::commit_front(size_t count) {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "direct fill requires a trivially copyable type");
+  if (count == 0) {
+    return;
+  }
+  if (info_.back == buffer_[info_.back_index]) {
+    info_.back = buffer_[--info_.back_index] + ChunkSize::kValue;
+  }
+  info_.back -= count;
+}
+
+// Binary search over the first elements of the occupied chunks, then within
+// the single chunk that can contain the cut point. Elements must be sorted by
+// proj. Returns the chunk index and element pointer of the result.
+template <typename T, typename Allocator>
+template <typename Key, typename Projection>
+std::pair<size_t, T*> Deque<T, Allocator>::lower_bound_position(
+    const Key& key, Projection& proj) const {
+  auto less = [&proj, &key](const T& elem) {
+    return std::invoke(proj, elem) < key;
+  };
+  if (info_.back == info_.front) {
+    return {info_.front_index, info_.front};
+  }
+  size_t last_index = (info_.front == buffer_[info_.front_index])
+                          ? info_.front_index - 1
+                          : info_.front_index;
+  size_t first = info_.back_index;
+  size_t count = last_index - info_.back_index + 1;
+  while (count > 0) {
+    size_t step = count / 2;
+    size_t middle = first + step;
+    const T& head =
+        (middle == info_.back_index) ? *info_.back : *buffer_[middle];
+    if (less(head)) {
+      first = middle + 1;
+      count -= step + 1;
+    } else {
+      count = step;
+    }
+  }
+  if (first == info_.back_index) {
+    return {info_.back_index, info_.back};
+  }
+  size_t index = first - 1;
+  T* begin = (index == info_.back_index) ? info_.back : buffer_[index];
+  T* end = (index == info_.front_index) ? info_.front
+                                        : buffer_[index] + ChunkSize::kValue;
+  T* found = std::partition_point(begin, end, less);
+  if (found == buffer_[index] + ChunkSize::kValue) {
+    return {index + 1, buffer_[index + 1]};
+  }
+  return {index, found};
+}
+
+template <typename T, typename Allocator>
+template <typename Key, typename Projection>
+typename Deque<T, Allocator>::iterator Deque<T, Allocator>::lower_bound(
+    const Key& key, Projection proj) {
+  auto [index, position] = lower_bound_position(key, proj);
+  return iterator(&buffer_[index], position);
+}
+
+template <typename T, typename Allocator>
+template <typename Key, typename Projection>
+typename Deque<T, Allocator>::const_iterator Deque<T, Allocator>::lower_bound(
+    const Key& key, Projection proj) const {
+  auto [index, position] = lower_bound_position(key, proj);
+  return const_iterator(const_cast<T**>(&buffer_[index]), position);
+}
+
+template <typename T, typename Allocator>
+template <typename Key, typename Projection>
+size_t Deque<T, Allocator>::pop_front_while_less(const Key& key,
+                                                 Projection proj) {
+  size_t count = lower_bound(key, proj) - begin();
+  pop_front_n(count);
+  return count;
+}
+
+template <typename T, typename Allocator>
+void Deque<T, Allocator>::erase_prefix_until(iterator iter) {
+  pop_front_n(iter - begin());
+}
+
+template <typename T, typename Allocator>
+template <typename Func>
+void Deque<T, Allocator>::for_each_segment(Func func) {
+  if (info_.back == info_.front) {
+    return;
+  }
+  for (size_t i = info_.back_index; i <= info_.front_index; ++i) {
+    T* begin = (i == info_.back_index) ? info_.back : buffer_[i];
+    T* end = (i == info_.front_index) ? info_.front
+                                      : buffer_[i] + ChunkSize::kValue;
+    if (begin != end) {
+      func(std::span<T>(begin, end));
+    }
+  }
+}
+
+template <typename T, typename Allocator>
+template <typename Func>
+void Deque<T, Allocator>::for_each_segment(Func func) const {
+  if (info_.back == info_.front) {
+    return;
+  }
+  for (size_t i = info_.back_index; i <= info_.front_index; ++i) {
+    const T* begin = (i == info_.back_index) ? info_.back : buffer_[i];
+    const T* end = (i == info_.front_index) ? info_.front
+                                            : buffer_[i] + ChunkSize::kValue;
+    if (begin != end) {
+      func(std::span<const T>(begin, end));
+    }
+  }
+}
+
+// The elements of the last occupied chunk: the longest contiguous run that
+// ends at end(). Empty only when the deque is empty.
+template <typename T, typename Allocator>
+std::span<T> Deque<T, Allocator>::back_segment() {
+  if (info_.back == info_.front) {
+    return std::span<T>();
+  }
+  size_t index = info_.front_index;
+  T* end = info_.front;
+  if (end == buffer_[index]) {
+    --index;
+    end = buffer_[index] + ChunkSize::kValue;
+  }
+  T* begin = (index == info_.back_index) ? info_.back : buffer_[index];
+  return std::span<T>(begin, end);
+}
+
+template <typename T, typename Allocator>
+std::span<const T> Deque<T, Allocator>::back_segment() const {
+  return const_cast<Deque*>(this)->back_segment();
+}
+
 template <typename T, typename Allocator>
 template <typename... Args>
 typename Deque<T, Allocator>::iterator Deque<T, Allocator>::emplace(
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <span>
+#include <utility>
+
+#include "Deque.hpp"
+
+// Sliding-window extremum over a stream: push_back() appends to the window,
+// pop_front() evicts its oldest element and front() returns the extremum
+// (the minimum for std::less) of the elements currently in the window.
+template <typename T, typename Compare = std::less<T>>
+class MonotonicDeque {
+ public:
+  using value_type = T;
+  using value_compare = Compare;
+
+  MonotonicDeque() {}
+  MonotonicDeque(const Compare& comp) : comp_(comp) {}
+
+  size_t size() const noexcept { return next_seq_ - front_seq_; }
+  bool empty() const noexcept { return size() == 0; }
+  const T& front() const { return entries_.begin()->value; }
+  void push_back(const T& value);
+  void push_back(T&& value);
+  template <typename Range>
+  void push_window(const Range& range);
+  void pop_front();
+  void pop_front_n(size_t count);
+  void clear() noexcept;
+
+ private:
+  struct Entry {
+    size_t seq;
+    T value;
+  };
+  static constexpr size_t kTrimWindow = 8;
+
+  void trim_back(const T& value);
+  [[no_unique_address]] Compare comp_;
+  Deque<Entry> entries_;
+  size_t front_seq_ = 0;
+  size_t next_seq_ = 0;
+};
+
+// Entries are sorted, so the dominated ones form a suffix. The last
+// kTrimWindow entries of the tail chunk are tested without data-dependent
+// branches by counting hits; only when all of them are dominated does the
+// suffix continue, and its start is then found by galloping from the back
+// followed by a binary search, which is O(log k) for k popped entries.
+template <typename T, typename Compare>
+void MonotonicDeque<T, Compare>::trim_back(const T& value) {
+  std::span<const Entry> tail = entries_.back_segment();
+  size_t window = std::min(tail.size(), kTrimWindow);
+  const Entry* last = tail.data() + tail.size();
+  size_t count = 0;
+  for (size_t i = 1; i <= window; ++i) {
+    count += static_cast<size_t>(comp_(value, last[-i].value));
+  }
+  size_t total = (count == window) ? entries_.size() : 0;
+  if (count < total) {
+    auto end = entries_.end();
+    size_t low = count;
+    size_t high = low * 2;
+    while (high < total && comp_(value, (end - high)->value)) {
+      low = high;
+      high *= 2;
+    }
+    high = std::min(high, total);
+    auto cut = std::upper_bound(
+        end - high, end - low, value,
+        [this](const T& key, const Entry& entry) {
+          return comp_(key, entry.value);
+        });
+    count = end - cut;
+  }
+  entries_.pop_back_n(count);
+}
+
+template <typename T, typename Compare>
+void MonotonicDeque<T, Compare>::push_back(const T& value) {
+  trim_back(value);
+  entries_.push_back(Entry{next_seq_, value});
+  ++next_seq_;
+}
+
+template <typename T, typename Compare>
+void MonotonicDeque<T, Compare>::push_back(T&& value) {
+  trim_back(value);
+  entries_.push_back(Entry{next_seq_, std::move(value)});
+  ++next_seq_;
+}
+
+// Every entry dominated by the extremum of the run is dominated by the run, so
+// that sorted suffix is located by binary search and dropped in one bulk pop;
+// the per-element loop afterwards only ever trims elements of the run itself.
+template <typename T, typename Compare>
+template <typename Range>
+void MonotonicDeque<T, Compare>::push_window(const Range& range) {
+  auto first = std::begin(range);
+  auto last = std::end(range);
+  if (first == last) {
+    return;
+  }
+  const T& extremum = *std::min_element(first, last, comp_);
+  auto cut = std::upper_bound(
+      entries_.begin(), entries_.end(), extremum,
+      [this](const T& value, const Entry& entry) {
+        return comp_(value, entry.value);
+      });
+  entries_.pop_back_n(entries_.end() - cut);
+  for (; first != last; ++first) {
+    push_back(*first);
+  }
+}
+
+template <typename T, typename Compare>
+void MonotonicDeque<T, Compare>::pop_front() {
+  if (entries_.begin()->seq == front_seq_) {
+    entries_.pop_front();
+  }
+  ++front_seq_;
+}
+
+template <typename T, typename Compare>
+void MonotonicDeque<T, Compare>::pop_front_n(size_t count) {
+  front_seq_ += count;
+  auto cut = std::lower_bound(
+      entries_.begin(), entries_.end(), front_seq_,
+      [](const Entry& entry, size_t seq) { return entry.seq < seq; });
+  entries_.pop_front_n(cut - entries_.begin());
+}
+
+template <typename T, typename Compare>
+void MonotonicDeque<T, Compare>::clear() noexcept {
+  entries_.clear();
+  front_seq_ = next_seq_;
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "Deque.hpp"
+
+// Append-only Deque addressed by sequence numbers: every pushed element gets
+// the next id, and ids stay valid across pop_front() and ack_until() until
+// the element itself is removed. Lookups are one subtraction on top of the
+// Deque index arithmetic.
+template <typename T, typename Allocator = std::allocator<T>>
+class SequenceDeque {
+ public:
+  using allocator_type = Allocator;
+  using value_type = T;
+  using sequence_type = uint64_t;
+  using iterator = typename Deque<T, Allocator>::iterator;
+  using const_iterator = typename Deque<T, Allocator>::const_iterator;
+
+  SequenceDeque() {}
+  SequenceDeque(sequence_type first_seq, const Allocator& alloc = Allocator())
+      : deque_(alloc), front_seq_(first_seq) {}
+
+  iterator begin() { return deque_.begin(); }
+  iterator end() { return deque_.end(); }
+  const_iterator begin() const { return deque_.begin(); }
+  const_iterator end() const { return deque_.end(); }
+  const_iterator cbegin() const { return deque_.cbegin(); }
+  const_iterator cend() const { return deque_.cend(); }
+
+  size_t size() const noexcept { return deque_.size(); }
+  bool empty() const noexcept { return deque_.empty(); }
+  sequence_type front_seq() const noexcept { return front_seq_; }
+  sequence_type next_seq() const noexcept { return front_seq_ + size(); }
+  bool contains_seq(sequence_type seq) const noexcept {
+    return seq - front_seq_ < size();
+  }
+  T& at_seq(sequence_type seq);
+  const T& at_seq(sequence_type seq) const;
+  iterator from_seq(sequence_type seq);
+  const_iterator from_seq(sequence_type seq) const;
+
+  sequence_type push_back(const T& value);
+  sequence_type push_back(T&& value);
+  template <typename... Args>
+  sequence_type emplace_back(Args&&... args);
+  void pop_front();
+  void ack_until(sequence_type seq);
+  void clear() noexcept;
+
+ private:
+  size_t clamped_offset(sequence_type seq) const noexcept;
+  Deque<T, Allocator> deque_;
+  sequence_type front_seq_ = 0;
+};
+
+template <typename T, typename Allocator>
+size_t SequenceDeque<T, Allocator>::clamped_offset(
+    sequence_type seq) const noexcept {
+  if (seq <= front_seq_) {
+    return 0;
+  }
+  return static_cast<size_t>(
+      std::min<sequence_type>(seq - front_seq_, size()));
+}
+
+template <typename T, typename Allocator>
+T& SequenceDeque<T, Allocator>::at_seq(sequence_type seq) {
+  if (!contains_seq(seq)) {
+    throw std::out_of_range("deque");
+  }
+  return deque_[seq - front_seq_];
+}
+
+template <typename T, typename Allocator>
+const T& SequenceDeque<T, Allocator>::at_seq(sequence_type seq) const {
+  if (!contains_seq(seq)) {
+    throw std::out_of_range("deque");
+  }
+  return deque_[seq - front_seq_];
+}
+
+template <typename T, typename Allocator>
+typename SequenceDeque<T, Allocator>::iterator
+SequenceDeque<T, Allocator>::from_seq(sequence_type seq) {
+  return deque_.begin() + clamped_offset(seq);
+}
+
+template <typename T, typename Allocator>
+typename SequenceDeque<T, Allocator>::const_iterator
+SequenceDeque<T, Allocator>::from_seq(sequence_type seq) const {
+  return deque_.begin() + clamped_offset(seq);
+}
+
+template <typename T, typename Allocator>
+typename SequenceDeque<T, Allocator>::sequence_type
+SequenceDeque<T, Allocator>::push_back(const T& value) {
+  return emplace_back(value);
+}
+
+template <typename T, typename Allocator>
+typename SequenceDeque<T, Allocator>::sequence_type
+SequenceDeque<T, Allocator>::push_back(T&& value) {
+  return emplace_back(std::move(value));
+}
+
+template <typename T, typename Allocator>
+template <typename... Args>
+typename SequenceDeque<T, Allocator>::sequence_type
+SequenceDeque<T, Allocator>::emplace_back(Args&&... args) {
+  sequence_type seq = next_seq();
+  deque_.emplace_back(std::forward<Args>(args)...);
+  return seq;
+}
+
+template <typename T, typename Allocator>
+void SequenceDeque<T, Allocator>::pop_front() {
+  deque_.pop_front();
+  ++front_seq_;
+}
+
+template <typename T, typename Allocator>
+void SequenceDeque<T, Allocator>::ack_until(sequence_type seq) {
+  size_t count = clamped_offset(seq);
+  deque_.pop_front_n(count);
+  front_seq_ += count;
+}
+
+template <typename T, typename Allocator>
+void SequenceDeque<T, Allocator>::clear() noexcept {
+  front_seq_ = next_seq();
+  deque_.clear();
+}
@@ -0,0 +1,378 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "Deque.hpp"
+
+// Columnar deque: rows are stored in blocks of kRows rows, each block holding
+// one array per field, so every column of a block shares the same row slots
+// and a scan over some columns only streams those columns' arrays. The block
+// map is a Deque of block pointers, which provides the two-ended growth,
+// chunk reuse and recentering; a row access is one block lookup plus an
+// offset. Elements are accessed through tuples of references. Fields must be
+// default constructible: a block's arrays are value-initialized when the
+// block is added, and popped rows of non-trivially destructible fields are
+// reset to a default value until their block is released.
+template <typename... Fields>
+class SoaDeque {
+ private:
+  static_assert(sizeof...(Fields) > 0, "SoaDeque needs at least one field");
+  static_assert((std::is_default_constructible_v<Fields> && ...),
+                "SoaDeque fields must be default constructible");
+  template <bool IsConst>
+  class CommonIterator;
+
+ public:
+  using value_type = std::tuple<Fields...>;
+  using reference = std::tuple<Fields&...>;
+  using const_reference = std::tuple<const Fields&...>;
+  using difference_type = std::ptrdiff_t;
+  using iterator = CommonIterator<false>;
+  using const_iterator = CommonIterator<true>;
+  template <size_t Column>
+  using column_type = std::tuple_element_t<Column, value_type>;
+
+  SoaDeque() {}
+  SoaDeque(const SoaDeque& other);
+  SoaDeque(SoaDeque&& other) noexcept;
+  SoaDeque& operator=(const SoaDeque& other);
+  SoaDeque& operator=(SoaDeque&& other) noexcept;
+
+  iterator begin() { return iterator(this, 0); }
+  iterator end() { return iterator(this, size()); }
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const { return const_iterator(this, size()); }
+  const_iterator cbegin() const { return const_iterator(this, 0); }
+  const_iterator cend() const { return const_iterator(this, size()); }
+
+  size_t size() const noexcept { return size_; }
+  bool empty() const noexcept { return size_ == 0; }
+  static constexpr size_t block_rows() noexcept { return kRows; }
+  reference operator[](size_t index) {
+    return element(index, std::index_sequence_for<Fields...>());
+  }
+  const_reference operator[](size_t index) const {
+    return element(index, std::index_sequence_for<Fields...>());
+  }
+  template <size_t Column>
+  column_type<Column>& get(size_t index) {
+    size_t row = first_ + index;
+    return std::get<Column>(*blocks_[row / kRows])[row % kRows];
+  }
+  template <size_t Column>
+  const column_type<Column>& get(size_t index) const {
+    size_t row = first_ + index;
+    return std::get<Column>(*blocks_[row / kRows])[row % kRows];
+  }
+  template <size_t... Columns, typename Func>
+  void for_each_segment(Func func);
+  template <size_t... Columns, typename Func>
+  void for_each_segment(Func func) const;
+
+  void push_back(const Fields&... fields);
+  void push_front(const Fields&... fields);
+  void pop_back();
+  void pop_front();
+  void pop_back_n(size_t count);
+  void pop_front_n(size_t count);
+  void clear() noexcept;
+
+ private:
+  static constexpr size_t kRowBytes = (sizeof(Fields) + ...);
+  static constexpr size_t kBlockBytes = 65536;
+  static constexpr size_t kRows =
+      std::bit_floor(std::max<size_t>(kBlockBytes / kRowBytes, 16));
+  using Block = std::tuple<std::array<Fields, kRows>...>;
+
+  template <size_t... Columns>
+  reference element(size_t index, std::index_sequence<Columns...>) {
+    size_t row = first_ + index;
+    Block& block = *blocks_[row / kRows];
+    return reference(std::get<Columns>(block)[row % kRows]...);
+  }
+  template <size_t... Columns>
+  const_reference element(size_t index,
+                          std::index_sequence<Columns...>) const {
+    size_t row = first_ + index;
+    const Block& block = *blocks_[row / kRows];
+    return const_reference(std::get<Columns>(block)[row % kRows]...);
+  }
+  template <size_t... Columns>
+  static void assign_row(Block& block, size_t slot,
+                         const const_reference& values,
+                         std::index_sequence<Columns...>);
+  template <size_t... Columns>
+  void reset_rows(size_t from, size_t to, std::index_sequence<Columns...>);
+  void release_empty() noexcept;
+
+  template <bool IsConst>
+  class CommonIterator {
+   public:
+    using iterator_category = std::random_access_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = SoaDeque::value_type;
+    using pointer = void;
+    using reference = std::conditional_t<IsConst, SoaDeque::const_reference,
+                                         SoaDeque::reference>;
+    using container_pointer =
+        std::conditional_t<IsConst, const SoaDeque*, SoaDeque*>;
+    CommonIterator() {}
+    CommonIterator(container_pointer deque, size_t index)
+        : deque_(deque), index_(index) {}
+    reference operator*() const { return (*deque_)[index_]; }
+    reference operator[](difference_type num) const {
+      return (*deque_)[index_ + num];
+    }
+    CommonIterator& operator++() {
+      ++index_;
+      return *this;
+    }
+    CommonIterator operator++(int) {
+      CommonIterator copy = *this;
+      ++index_;
+      return copy;
+    }
+    CommonIterator& operator--() {
+      --index_;
+      return *this;
+    }
+    CommonIterator operator--(int) {
+      CommonIterator copy = *this;
+      --index_;
+      return copy;
+    }
+    CommonIterator& operator+=(difference_type num) {
+      index_ += num;
+      return *this;
+    }
+    CommonIterator& operator-=(difference_type num) {
+      index_ -= num;
+      return *this;
+    }
+    CommonIterator operator+(difference_type num) const {
+      return CommonIterator(deque_, index_ + num);
+    }
+    CommonIterator operator-(difference_type num) const {
+      return CommonIterator(deque_, index_ - num);
+    }
+    friend CommonIterator operator+(difference_type num,
+                                    const CommonIterator& iter) {
+      return iter + num;
+    }
+    friend difference_type operator-(const CommonIterator& iter1,
+                                     const CommonIterator& iter2) {
+      return static_cast<difference_type>(iter1.index_) -
+             static_cast<difference_type>(iter2.index_);
+    }
+    friend bool operator==(const CommonIterator& iter1,
+                           const CommonIterator& iter2) {
+      return iter1.index_ == iter2.index_;
+    }
+    friend bool operator!=(const CommonIterator& iter1,
+                           const CommonIterator& iter2) {
+      return !(iter1 == iter2);
+    }
+    friend bool operator<(const CommonIterator& iter1,
+                          const CommonIterator& iter2) {
+      return iter1.index_ < iter2.index_;
+    }
+    friend bool operator>(const CommonIterator& iter1,
+                          const CommonIterator& iter2) {
+      return iter2 < iter1;
+    }
+    friend bool operator<=(const CommonIterator& iter1,
+                           const CommonIterator& iter2) {
+      return !(iter2 < iter1);
+    }
+    friend bool operator>=(const CommonIterator& iter1,
+                           const CommonIterator& iter2) {
+      return !(iter1 < iter2);
+    }
+
+   private:
+    container_pointer deque_ = nullptr;
+    size_t index_ = 0;
+  };
+
+  Deque<std::unique_ptr<Block>> blocks_;
+  size_t first_ = 0;
+  size_t size_ = 0;
+};
+
+template <typename... Fields>
+SoaDeque<Fields...>::SoaDeque(const SoaDeque& other)
+    : first_(other.first_), size_(other.size_) {
+  for (const auto& block : other.blocks_) {
+    blocks_.push_back(std::make_unique<Block>(*block));
+  }
+}
+
+template <typename... Fields>
+SoaDeque<Fields...>::SoaDeque(SoaDeque&& other) noexcept
+    : blocks_(std::move(other.blocks_)),
+      first_(std::exchange(other.first_, 0)),
+      size_(std::exchange(other.size_, 0)) {}
+
+template <typename... Fields>
+SoaDeque<Fields...>& SoaDeque<Fields...>::operator=(const SoaDeque& other) {
+  if (this != &other) {
+    *this = SoaDeque(other);
+  }
+  return *this;
+}
+
+template <typename... Fields>
+SoaDeque<Fields...>& SoaDeque<Fields...>::operator=(SoaDeque&& other) noexcept {
+  blocks_ = std::move(other.blocks_);
+  first_ = std::exchange(other.first_, 0);
+  size_ = std::exchange(other.size_, 0);
+  return *this;
+}
+
+template <typename... Fields>
+template <size_t... Columns>
+void SoaDeque<Fields...>::assign_row(Block& block, size_t slot,
+                                     const const_reference& values,
+                                     std::index_sequence<Columns...>) {
+  ((std::get<Columns>(block)[slot] = std::get<Columns>(values)), ...);
+}
+
+template <typename... Fields>
+template <size_t... Columns>
+void SoaDeque<Fields...>::reset_rows(size_t from, size_t to,
+                                     std::index_sequence<Columns...>) {
+  auto reset_column = [this, from, to](auto column) {
+    using Field = column_type<decltype(column)::value>;
+    if constexpr (!std::is_trivially_destructible_v<Field>) {
+      for (size_t i = from; i < to; ++i) {
+        get<decltype(column)::value>(i) = Field();
+      }
+    }
+  };
+  (reset_column(std::integral_constant<size_t, Columns>()), ...);
+}
+
+template <typename... Fields>
+void SoaDeque<Fields...>::release_empty() noexcept {
+  if (size_ == 0) {
+    blocks_.clear();
+    first_ = 0;
+  }
+}
+
+template <typename... Fields>
+void SoaDeque<Fields...>::push_back(const Fields&... fields) {
+  size_t row = first_ + size_;
+  bool grown = (row % kRows == 0);
+  if (grown) {
+    blocks_.push_back(std::make_unique<Block>());
+  }
+  try {
+    assign_row(**(blocks_.end() - 1), row % kRows, const_reference(fields...),
+               std::index_sequence_for<Fields...>());
+  } catch (...) {
+    if (grown) {
+      blocks_.pop_back_n(1);
+    }
+    throw;
+  }
+  ++size_;
+}
+
+template <typename... Fields>
+void SoaDeque<Fields...>::push_front(const Fields&... fields) {
+  bool grown = (first_ == 0);
+  if (grown) {
+    blocks_.push_front(std::make_unique<Block>());
+  }
+  size_t slot = (grown ? kRows : first_) - 1;
+  try {
+    assign_row(**blocks_.begin(), slot, const_reference(fields...),
+               std::index_sequence_for<Fields...>());
+  } catch (...) {
+    if (grown) {
+      blocks_.pop_front_n(1);
+    }
+    throw;
+  }
+  first_ = slot;
+  ++size_;
+}
+
+template <typename... Fields>
+void SoaDeque<Fields...>::pop_back() {
+  pop_back_n(1);
+}
+
+template <typename... Fields>
+void SoaDeque<Fields...>::pop_front() {
+  pop_front_n(1);
+}
+
+template <typename... Fields>
+void SoaDeque<Fields...>::pop_back_n(size_t count) {
+  reset_rows(size_ - count, size_, std::index_sequence_for<Fields...>());
+  size_ -= count;
+  size_t used = (first_ + size_ + kRows - 1) / kRows;
+  blocks_.pop_back_n(blocks_.size() - used);
+  release_empty();
+}
+
+template <typename... Fields>
+void SoaDeque<Fields...>::pop_front_n(size_t count) {
+  reset_rows(0, count, std::index_sequence_for<Fields...>());
+  first_ += count;
+  size_ -= count;
+  blocks_.pop_front_n(first_ / kRows);
+  first_ %= kRows;
+  release_empty();
+}
+
+template <typename... Fields>
+void SoaDeque<Fields...>::clear() noexcept {
+  blocks_.clear();
+  first_ = 0;
+  size_ = 0;
+}
+
+// Passes, for every block, one span per requested column covering the rows
+// of that block that hold elements; the spans of one call are aligned row by
+// row.
+template <typename... Fields>
+template <size_t... Columns, typename Func>
+void SoaDeque<Fields...>::for_each_segment(Func func) {
+  static_assert(sizeof...(Columns) > 0, "for_each_segment needs a column");
+  size_t first = first_;
+  size_t remaining = size_;
+  for (auto& block : blocks_) {
+    size_t count = std::min(kRows - first, remaining);
+    func(std::span<column_type<Columns>>(
+        std::get<Columns>(*block).data() + first, count)...);
+    remaining -= count;
+    first = 0;
+  }
+}
+
+template <typename... Fields>
+template <size_t... Columns, typename Func>
+void SoaDeque<Fields...>::for_each_segment(Func func) const {
+  static_assert(sizeof...(Columns) > 0, "for_each_segment needs a column");
+  size_t first = first_;
+  size_t remaining = size_;
+  for (const auto& block : blocks_) {
+    size_t count = std::min(kRows - first, remaining);
+    func(std::span<const column_type<Columns>>(
+        std::get<Columns>(*block).data() + first, count)...);
+    remaining -= count;
+    first = 0;
+  }
+}
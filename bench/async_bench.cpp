@@ -0,0 +1,148 @@
+// Producer/consumer handoff: AsyncDeque coroutines on one EventLoop against
+// two threads sharing a std::deque guarded by a mutex and condition variables.
+// "ping-pong" bounces one value per round trip between two queues; "stream"
+// pushes values through a single queue bounded to a small capacity.
+//   g++ -std=c++20 -O2 -pthread -I.. async_bench.cpp -o async_bench
+//   ./async_bench [round_trips] [capacity]
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "AsyncDeque.hpp"
+
+struct Task {
+  struct promise_type {
+    Task get_return_object() { return {}; }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_void() {}
+    void unhandled_exception() { std::abort(); }
+  };
+};
+
+class BlockingQueue {
+ public:
+  BlockingQueue(size_t capacity) : capacity_(capacity) {}
+  void push(int value) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      not_full_.wait(lock, [this] { return items_.size() < capacity_; });
+      items_.push_back(value);
+    }
+    not_empty_.notify_one();
+  }
+  int pop() {
+    int value;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      not_empty_.wait(lock, [this] { return !items_.empty(); });
+      value = items_.front();
+      items_.pop_front();
+    }
+    not_full_.notify_one();
+    return value;
+  }
+
+ private:
+  size_t capacity_;
+  std::mutex mutex_;
+  std::condition_variable not_empty_;
+  std::condition_variable not_full_;
+  std::deque<int> items_;
+};
+
+Task ping(AsyncDeque<int>& out, AsyncDeque<int>& in, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    co_await out.push_back(static_cast<int>(i));
+    co_await in.pop_front();
+  }
+}
+
+Task pong(AsyncDeque<int>& in, AsyncDeque<int>& out, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    int value = co_await in.pop_front();
+    co_await out.push_back(value);
+  }
+}
+
+Task produce(AsyncDeque<int>& out, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    co_await out.push_back(static_cast<int>(i));
+  }
+}
+
+Task consume(AsyncDeque<int>& in, size_t count, long long& sum) {
+  for (size_t i = 0; i < count; ++i) {
+    sum += co_await in.pop_front();
+  }
+}
+
+template <typename Func>
+double ns_per_op(size_t ops, Func func) {
+  auto start = std::chrono::steady_clock::now();
+  func();
+  std::chrono::duration<double, std::nano> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count() / static_cast<double>(ops);
+}
+
+int main(int argc, char** argv) {
+  size_t round_trips = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200000;
+  size_t capacity = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 64;
+  size_t values = round_trips * 10;
+
+  double coro_ping = ns_per_op(round_trips, [&] {
+    EventLoop loop;
+    AsyncDeque<int> there(loop), back(loop);
+    pong(there, back, round_trips);
+    ping(there, back, round_trips);
+    loop.run();
+  });
+  double cv_ping = ns_per_op(round_trips, [&] {
+    BlockingQueue there(capacity), back(capacity);
+    std::thread echo([&] {
+      for (size_t i = 0; i < round_trips; ++i) {
+        back.push(there.pop());
+      }
+    });
+    for (size_t i = 0; i < round_trips; ++i) {
+      there.push(static_cast<int>(i));
+      back.pop();
+    }
+    echo.join();
+  });
+
+  long long coro_sum = 0;
+  long long cv_sum = 0;
+  double coro_stream = ns_per_op(values, [&] {
+    EventLoop loop;
+    AsyncDeque<int> channel(loop, capacity);
+    consume(channel, values, coro_sum);
+    produce(channel, values);
+    loop.run();
+  });
+  double cv_stream = ns_per_op(values, [&] {
+    BlockingQueue channel(capacity);
+    std::thread consumer([&] {
+      for (size_t i = 0; i < values; ++i) {
+        cv_sum += channel.pop();
+      }
+    });
+    for (size_t i = 0; i < values; ++i) {
+      channel.push(static_cast<int>(i));
+    }
+    consumer.join();
+  });
+
+  std::printf("round_trips=%zu capacity=%zu\n", round_trips, capacity);
+  std::printf(
+      "ping-pong: AsyncDeque %.1f ns  mutex+cv %.1f ns per round trip\n",
+      coro_ping, cv_ping);
+  std::printf("stream:    AsyncDeque %.1f ns  mutex+cv %.1f ns per value\n",
+              coro_stream, cv_stream);
+  return coro_sum == cv_sum ? 0 : 1;
+}
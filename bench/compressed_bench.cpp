@@ -0,0 +1,136 @@
+// Monotonic int64 timestamps in CompressedDeque versus Deque<int64_t>:
+// heap bytes actually allocated (counted by a replacement operator new),
+// memory_usage(), full scans and uniformly random reads.
+//   g++ -std=c++20 -O2 -I.. compressed_bench.cpp -o compressed_bench
+//   ./compressed_bench [elements] [random_reads]
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "CompressedDeque.hpp"
+
+namespace {
+size_t live_bytes = 0;
+}
+
+void* operator new(size_t size) {
+  void* block = std::malloc(size + 16);
+  if (block == nullptr) {
+    throw std::bad_alloc();
+  }
+  *static_cast<size_t*>(block) = size;
+  live_bytes += size;
+  return static_cast<char*>(block) + 16;
+}
+
+void operator delete(void* pointer) noexcept {
+  if (pointer != nullptr) {
+    char* block = static_cast<char*>(pointer) - 16;
+    live_bytes -= *reinterpret_cast<size_t*>(block);
+    std::free(block);
+  }
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+  operator delete(pointer);
+}
+
+template <typename Func>
+double ns_per_op(size_t ops, Func func) {
+  auto start = std::chrono::steady_clock::now();
+  func();
+  std::chrono::duration<double, std::nano> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count() / ops;
+}
+
+template <typename Container>
+void fill(Container& container, size_t elements) {
+  std::mt19937 rng(1);
+  int64_t timestamp = 1700000000000000000;
+  for (size_t i = 0; i < elements; ++i) {
+    timestamp += 1000 + rng() % 50;
+    container.push_back(timestamp);
+  }
+}
+
+int main(int argc, char** argv) {
+  size_t elements = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+  size_t reads = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 1000000;
+
+  size_t before = live_bytes;
+  Deque<int64_t> plain;
+  fill(plain, elements);
+  size_t plain_heap = live_bytes - before;
+
+  before = live_bytes;
+  CompressedDeque<int64_t> compressed;
+  fill(compressed, elements);
+  size_t compressed_heap = live_bytes - before;
+
+  std::mt19937_64 rng(2);
+  std::vector<size_t> indices(reads);
+  for (auto& index : indices) {
+    index = rng() % elements;
+  }
+
+  int64_t plain_sum = 0;
+  double plain_scan = ns_per_op(elements, [&] {
+    plain.for_each_segment([&](std::span<const int64_t> segment) {
+      for (int64_t value : segment) {
+        plain_sum += value;
+      }
+    });
+  });
+  int64_t compressed_sum = 0;
+  double compressed_scan = ns_per_op(elements, [&] {
+    compressed.for_each_segment([&](std::span<const int64_t> segment) {
+      for (int64_t value : segment) {
+        compressed_sum += value;
+      }
+    });
+  });
+  int64_t plain_random = 0;
+  double plain_read = ns_per_op(reads, [&] {
+    for (size_t index : indices) {
+      plain_random += plain[index];
+    }
+  });
+  int64_t compressed_random = 0;
+  double compressed_read = ns_per_op(reads, [&] {
+    for (size_t index : indices) {
+      compressed_random += compressed[index];
+    }
+  });
+  int64_t compressed_sequential = 0;
+  double sequential_read = ns_per_op(elements, [&] {
+    for (size_t i = 0; i < elements; ++i) {
+      compressed_sequential += compressed[i];
+    }
+  });
+
+  if (plain_sum != compressed_sum || plain_random != compressed_random ||
+      plain_sum != compressed_sequential) {
+    std::printf("mismatch\n");
+    return 1;
+  }
+  double raw = static_cast<double>(elements * sizeof(int64_t));
+  std::printf("elements=%zu raw=%.1f MiB\n", elements, raw / (1 << 20));
+  std::printf("heap: Deque %.1f MiB, CompressedDeque %.1f MiB (%.2fx of raw)\n",
+              plain_heap / double(1 << 20), compressed_heap / double(1 << 20),
+              raw / compressed_heap);
+  std::printf("memory_usage(): %.1f MiB, compression_ratio() %.2f\n",
+              compressed.memory_usage() / double(1 << 20),
+              compressed.compression_ratio());
+  std::printf("scan:            Deque %.2f ns  CompressedDeque %.2f ns\n",
+              plain_scan, compressed_scan);
+  std::printf("random read:     Deque %.2f ns  CompressedDeque %.2f ns\n",
+              plain_read, compressed_read);
+  std::printf("sequential [i]:  CompressedDeque %.2f ns\n", sequential_read);
+  return 0;
+}
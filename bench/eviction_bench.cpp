@@ -0,0 +1,78 @@
+// Time-windowed eviction at high event rates: every tick appends a burst of
+// timestamped events and evicts everything older than the window, either by
+// checking the front and calling pop_front() per event or with
+// pop_front_while_less().
+//   g++ -std=c++20 -O2 -I.. eviction_bench.cpp -o eviction_bench
+//   ./eviction_bench [events_per_tick] [ticks]
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include "Deque.hpp"
+
+struct Event {
+  int64_t timestamp;
+  int64_t payload;
+};
+
+// Returns the eviction time per evicted event in nanoseconds.
+template <typename Evict>
+double run(size_t events_per_tick, size_t ticks, int64_t window, Evict evict,
+           size_t& retained) {
+  Deque<Event> events;
+  std::chrono::duration<double, std::nano> evicting{0};
+  for (size_t tick = 0; tick < ticks; ++tick) {
+    int64_t now = static_cast<int64_t>(tick) * 1000;
+    for (size_t i = 0; i < events_per_tick; ++i) {
+      events.push_back(Event{now + static_cast<int64_t>(i % 1000),
+                             static_cast<int64_t>(i)});
+    }
+    auto start = std::chrono::steady_clock::now();
+    evict(events, now - window);
+    evicting += std::chrono::steady_clock::now() - start;
+  }
+  retained = events.size();
+  return evicting.count() /
+         static_cast<double>(events_per_tick * ticks - retained);
+}
+
+int main(int argc, char** argv) {
+  size_t events_per_tick =
+      (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 10000;
+  size_t ticks = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 2000;
+  const int64_t kWindow = 100 * 1000;
+  if (ticks <= 101) {
+    std::printf("ticks must exceed the 100-tick window\n");
+    return 1;
+  }
+  size_t retained_loop = 0;
+  double per_event_loop = run(
+      events_per_tick, ticks, kWindow,
+      [](Deque<Event>& events, int64_t cutoff) {
+        while (!events.empty() && events.begin()->timestamp < cutoff) {
+          events.pop_front();
+        }
+      },
+      retained_loop);
+  size_t retained_bulk = 0;
+  double per_event_bulk = run(
+      events_per_tick, ticks, kWindow,
+      [](Deque<Event>& events, int64_t cutoff) {
+        events.pop_front_while_less(cutoff, &Event::timestamp);
+      },
+      retained_bulk);
+  if (retained_loop != retained_bulk) {
+    std::printf("mismatch: %zu vs %zu retained\n", retained_loop,
+                retained_bulk);
+    return 1;
+  }
+  std::printf("events/tick=%zu ticks=%zu retained=%zu\n", events_per_tick,
+              ticks, retained_bulk);
+  std::printf("eviction cost per evicted event:\n");
+  std::printf("  front check + pop_front: %.3f ns (%.0f M events/s)\n",
+              per_event_loop, 1e3 / per_event_loop);
+  std::printf("  pop_front_while_less:    %.3f ns (%.0f M events/s)\n",
+              per_event_bulk, 1e3 / per_event_bulk);
+  return 0;
+}
@@ -0,0 +1,89 @@
+// Uniformly random lookups over a deque larger than the last-level cache.
+// Compares an operator[] loop with Deque::gather(), first as a bare copy and
+// then with per-element work done by the consumer of each value.
+//   g++ -std=c++20 -O2 -I.. gather_bench.cpp -o gather_bench
+//   ./gather_bench [elements] [lookups]
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "Deque.hpp"
+
+template <typename Func>
+double best_ns_per_op(size_t ops, Func func) {
+  double best = 1e300;
+  for (int rep = 0; rep < 5; ++rep) {
+    auto start = std::chrono::steady_clock::now();
+    func();
+    std::chrono::duration<double, std::nano> elapsed =
+        std::chrono::steady_clock::now() - start;
+    best = std::min(best, elapsed.count() / ops);
+  }
+  return best;
+}
+
+uint64_t mix(uint64_t value) {
+  for (int round = 0; round < 24; ++round) {
+    value = (value ^ (value >> 29)) * 0xbf58476d1ce4e5b9ULL;
+  }
+  return value;
+}
+
+struct MixingSink {
+  uint64_t* total;
+  MixingSink& operator*() { return *this; }
+  MixingSink& operator++() { return *this; }
+  MixingSink& operator=(long value) {
+    *total += mix(static_cast<uint64_t>(value));
+    return *this;
+  }
+};
+
+int main(int argc, char** argv) {
+  size_t elements = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 64 << 20;
+  size_t lookups = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 4 << 20;
+  Deque<long> deque;
+  for (size_t i = 0; i < elements; ++i) {
+    deque.push_back(static_cast<long>(i));
+  }
+  std::mt19937_64 rng(42);
+  std::vector<size_t> indices(lookups);
+  for (auto& index : indices) {
+    index = rng() % elements;
+  }
+  std::vector<long> out(lookups);
+  uint64_t checksum = 0;
+
+  double copy_plain = best_ns_per_op(lookups, [&] {
+    for (size_t i = 0; i < lookups; ++i) {
+      out[i] = deque[indices[i]];
+    }
+    checksum += out[lookups / 2];
+  });
+  double copy_gather = best_ns_per_op(lookups, [&] {
+    deque.gather(indices, out.begin());
+    checksum += out[lookups / 2];
+  });
+  uint64_t plain_total = 0;
+  double work_plain = best_ns_per_op(lookups, [&] {
+    for (size_t i = 0; i < lookups; ++i) {
+      plain_total += mix(static_cast<uint64_t>(deque[indices[i]]));
+    }
+  });
+  uint64_t gather_total = 0;
+  double work_gather = best_ns_per_op(lookups, [&] {
+    deque.gather(indices, MixingSink{&gather_total});
+  });
+
+  std::printf("elements=%zu (%zu MiB) lookups=%zu\n", elements,
+              elements * sizeof(long) >> 20, lookups);
+  std::printf("copy:      operator[] %6.2f ns  gather %6.2f ns  (%.2fx)\n",
+              copy_plain, copy_gather, copy_plain / copy_gather);
+  std::printf("with work: operator[] %6.2f ns  gather %6.2f ns  (%.2fx)\n",
+              work_plain, work_gather, work_plain / work_gather);
+  return (plain_total == gather_total && checksum != 0) ? 0 : 1;
+}
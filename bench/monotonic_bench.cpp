@@ -0,0 +1,83 @@
+// Sliding-window minimum over a random stream: MonotonicDeque versus a
+// std::multiset window, for window sizes from 10 to 10^6.
+//   g++ -std=c++20 -O2 -I.. monotonic_bench.cpp -o monotonic_bench
+//   ./monotonic_bench [stream_length]
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <set>
+#include <span>
+#include <vector>
+
+#include "MonotonicDeque.hpp"
+
+template <typename Func>
+double ns_per_op(size_t ops, Func func) {
+  auto start = std::chrono::steady_clock::now();
+  func();
+  std::chrono::duration<double, std::nano> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count() / ops;
+}
+
+int main(int argc, char** argv) {
+  size_t length = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 4000000;
+  std::mt19937_64 rng(7);
+  std::vector<int64_t> stream(length);
+  for (auto& value : stream) {
+    value = static_cast<int64_t>(rng() % 1000000007);
+  }
+  std::printf("%10s %14s %14s %16s\n", "window", "multiset ns", "monotonic ns",
+              "batch(64) ns");
+  const size_t kBatch = 64;
+  std::vector<int64_t> expected((length + kBatch - 1) / kBatch);
+  std::vector<int64_t> batched_fronts(expected.size());
+  for (size_t window = 10; window <= 1000000; window *= 10) {
+    int64_t multiset_sum = 0;
+    double multiset = ns_per_op(length, [&] {
+      std::multiset<int64_t> values;
+      for (size_t i = 0; i < length; ++i) {
+        values.insert(stream[i]);
+        if (i >= window) {
+          values.erase(values.find(stream[i - window]));
+        }
+        multiset_sum += *values.begin();
+        if ((i + 1) % kBatch == 0 || i + 1 == length) {
+          expected[i / kBatch] = *values.begin();
+        }
+      }
+    });
+    int64_t monotonic_sum = 0;
+    double monotonic = ns_per_op(length, [&] {
+      MonotonicDeque<int64_t> values;
+      for (size_t i = 0; i < length; ++i) {
+        values.push_back(stream[i]);
+        if (values.size() > window) {
+          values.pop_front();
+        }
+        monotonic_sum += values.front();
+      }
+    });
+    double batched = ns_per_op(length, [&] {
+      MonotonicDeque<int64_t> values;
+      for (size_t i = 0; i < length; i += kBatch) {
+        size_t end = std::min(length, i + kBatch);
+        values.push_window(std::span<const int64_t>(&stream[i], end - i));
+        if (values.size() > window) {
+          values.pop_front_n(values.size() - window);
+        }
+        batched_fronts[i / kBatch] = values.front();
+      }
+    });
+    if (multiset_sum != monotonic_sum || batched_fronts != expected) {
+      std::printf("mismatch at window %zu\n", window);
+      return 1;
+    }
+    std::printf("%10zu %14.2f %14.2f %16.2f\n", window, multiset, monotonic,
+                batched);
+  }
+  return 0;
+}
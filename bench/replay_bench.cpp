@@ -0,0 +1,110 @@
+// Replay-buffer workload: messages are appended with increasing sequence
+// numbers, acknowledged cumulatively in batches, and a few percent of acks
+// trigger a retransmit that replays a short range starting at a sequence id.
+// SequenceDeque is compared with std::deque plus a hand-kept base offset.
+//   g++ -std=c++20 -O2 -I.. replay_bench.cpp -o replay_bench
+//   ./replay_bench [messages] [in_flight]
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <random>
+
+#include "SequenceDeque.hpp"
+
+struct Message {
+  uint64_t seq;
+  uint32_t length;
+  char payload[52];
+};
+
+const uint64_t kAckBatch = 64;
+const uint64_t kReplayLength = 16;
+
+template <typename Func>
+double million_per_second(uint64_t messages, Func func) {
+  auto start = std::chrono::steady_clock::now();
+  func();
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return static_cast<double>(messages) / elapsed.count() / 1e6;
+}
+
+int main(int argc, char** argv) {
+  uint64_t messages =
+      (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 20000000;
+  uint64_t in_flight = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 4096;
+  if (in_flight < 4) {
+    std::printf("in_flight must be at least 4\n");
+    return 1;
+  }
+
+  uint64_t sequence_checksum = 0;
+  double sequence_rate = million_per_second(messages, [&] {
+    std::mt19937 rng(3);
+    SequenceDeque<Message> buffer;
+    for (uint64_t i = 0; i < messages; ++i) {
+      uint64_t seq = buffer.push_back(Message{i, 52, {}});
+      if (buffer.size() >= in_flight && seq % kAckBatch == 0) {
+        uint64_t acked = buffer.next_seq() - in_flight / 2;
+        buffer.ack_until(acked);
+        if (rng() % 32 == 0) {
+          uint64_t from = acked + rng() % (in_flight / 4);
+          auto iter = buffer.from_seq(from);
+          for (uint64_t k = 0; k < kReplayLength && iter != buffer.end();
+               ++k, ++iter) {
+            sequence_checksum += iter->seq;
+          }
+          if (buffer.contains_seq(from)) {
+            sequence_checksum += buffer.at_seq(from).length;
+          }
+        }
+      }
+    }
+  });
+
+  uint64_t offset_checksum = 0;
+  double offset_rate = million_per_second(messages, [&] {
+    std::mt19937 rng(3);
+    std::deque<Message> buffer;
+    uint64_t front_seq = 0;
+    for (uint64_t i = 0; i < messages; ++i) {
+      uint64_t seq = front_seq + buffer.size();
+      buffer.push_back(Message{i, 52, {}});
+      if (buffer.size() >= in_flight && seq % kAckBatch == 0) {
+        uint64_t acked = front_seq + buffer.size() - in_flight / 2;
+        while (front_seq < acked) {
+          buffer.pop_front();
+          ++front_seq;
+        }
+        if (rng() % 32 == 0) {
+          uint64_t from = acked + rng() % (in_flight / 4);
+          auto iter = buffer.begin() + static_cast<std::ptrdiff_t>(
+                                           std::min<uint64_t>(
+                                               from - front_seq,
+                                               buffer.size()));
+          for (uint64_t k = 0; k < kReplayLength && iter != buffer.end();
+               ++k, ++iter) {
+            offset_checksum += iter->seq;
+          }
+          if (from - front_seq < buffer.size()) {
+            offset_checksum += buffer[from - front_seq].length;
+          }
+        }
+      }
+    }
+  });
+
+  if (sequence_checksum != offset_checksum) {
+    std::printf("checksum mismatch\n");
+    return 1;
+  }
+  std::printf("messages=%llu in_flight=%llu\n",
+              static_cast<unsigned long long>(messages),
+              static_cast<unsigned long long>(in_flight));
+  std::printf("SequenceDeque:           %.1f M messages/s\n", sequence_rate);
+  std::printf("std::deque + offset:     %.1f M messages/s\n", offset_rate);
+  return 0;
+}
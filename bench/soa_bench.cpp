@@ -0,0 +1,127 @@
+// Column scans: summing one field, and the product of two fields, of a record
+// stream stored as Deque<Record> versus SoaDeque, plus the cost of appending
+// rows.
+//   g++ -std=c++20 -O2 -I.. soa_bench.cpp -o soa_bench
+//   ./soa_bench [records]
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <span>
+
+#include "SoaDeque.hpp"
+
+struct Record {
+  uint64_t ts;
+  double px;
+  int32_t qty;
+  int32_t venue;
+  uint64_t order_id;
+  double fee;
+};
+
+template <typename Func>
+double best_ns_per_op(size_t ops, Func func) {
+  double best = 1e300;
+  for (int rep = 0; rep < 5; ++rep) {
+    auto start = std::chrono::steady_clock::now();
+    func();
+    std::chrono::duration<double, std::nano> elapsed =
+        std::chrono::steady_clock::now() - start;
+    best = std::min(best, elapsed.count() / ops);
+  }
+  return best;
+}
+
+int main(int argc, char** argv) {
+  size_t records = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 20000000;
+  Deque<Record> rows;
+  SoaDeque<uint64_t, double, int32_t, int32_t, uint64_t, double> columns;
+  double push_rows = best_ns_per_op(records, [&] {
+    rows.clear();
+    for (size_t i = 0; i < records; ++i) {
+      rows.push_back(Record{i, 0.5 * static_cast<double>(i % 1000),
+                            static_cast<int32_t>(i % 100), 1, i, 0.01});
+    }
+  });
+  double push_columns = best_ns_per_op(records, [&] {
+    columns.clear();
+    for (size_t i = 0; i < records; ++i) {
+      columns.push_back(i, 0.5 * static_cast<double>(i % 1000),
+                        static_cast<int32_t>(i % 100), 1, i, 0.01);
+    }
+  });
+
+  double row_sum = 0;
+  double scan_rows = best_ns_per_op(records, [&] {
+    row_sum = 0;
+    rows.for_each_segment([&](std::span<const Record> segment) {
+      for (const Record& record : segment) {
+        row_sum += record.px;
+      }
+    });
+  });
+  double column_sum = 0;
+  double scan_column = best_ns_per_op(records, [&] {
+    column_sum = 0;
+    columns.for_each_segment<1>([&](std::span<const double> segment) {
+      for (double px : segment) {
+        column_sum += px;
+      }
+    });
+  });
+  int64_t row_qty = 0;
+  double scan_rows_int = best_ns_per_op(records, [&] {
+    row_qty = 0;
+    rows.for_each_segment([&](std::span<const Record> segment) {
+      for (const Record& record : segment) {
+        row_qty += record.qty;
+      }
+    });
+  });
+  int64_t column_qty = 0;
+  double scan_column_int = best_ns_per_op(records, [&] {
+    column_qty = 0;
+    columns.for_each_segment<2>([&](std::span<const int32_t> segment) {
+      for (int32_t qty : segment) {
+        column_qty += qty;
+      }
+    });
+  });
+  double row_notional = 0;
+  double scan_rows_pair = best_ns_per_op(records, [&] {
+    row_notional = 0;
+    rows.for_each_segment([&](std::span<const Record> segment) {
+      for (const Record& record : segment) {
+        row_notional += record.px * record.qty;
+      }
+    });
+  });
+  double column_notional = 0;
+  double scan_column_pair = best_ns_per_op(records, [&] {
+    column_notional = 0;
+    columns.for_each_segment<1, 2>(
+        [&](std::span<const double> px, std::span<const int32_t> qty) {
+          for (size_t i = 0; i < px.size(); ++i) {
+            column_notional += px[i] * qty[i];
+          }
+        });
+  });
+  if (row_sum != column_sum || row_qty != column_qty ||
+      row_notional != column_notional) {
+    std::printf("mismatch\n");
+    return 1;
+  }
+  std::printf("records=%zu sizeof(Record)=%zu rows/block=%zu\n", records,
+              sizeof(Record), columns.block_rows());
+  std::printf("sum px  (double): Deque<Record> %.3f ns  SoaDeque %.3f ns\n",
+              scan_rows, scan_column);
+  std::printf("sum qty (int32):  Deque<Record> %.3f ns  SoaDeque %.3f ns\n",
+              scan_rows_int, scan_column_int);
+  std::printf("sum px*qty:       Deque<Record> %.3f ns  SoaDeque %.3f ns\n",
+              scan_rows_pair, scan_column_pair);
+  std::printf("push_back row:    Deque<Record> %.3f ns  SoaDeque %.3f ns\n",
+              push_rows, push_columns);
+  return 0;
+}